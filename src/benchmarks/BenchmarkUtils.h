@@ -0,0 +1,43 @@
+#pragma once
+
+// Shared helpers for the benchmarks. Every benchmark is a standalone program with its own main, so none of them are part of
+// the vector project. Build them separately with optimizations on (see README)
+
+#include <chrono>
+#include <cstddef>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <fstream>
+#include <unistd.h>
+#endif
+
+// Wall time of a single call, in milliseconds
+template<typename Func>
+double measure_ms(Func func)
+{
+	const auto start = std::chrono::steady_clock::now();
+	func();
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Resident set size of the whole process, in MB
+inline std::size_t resident_mb()
+{
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+	return counters.WorkingSetSize / (1024 * 1024);
+#else
+	// Second field of statm is the resident page count
+	std::size_t total_pages = 0, resident_pages = 0;
+	std::ifstream("/proc/self/statm") >> total_pages >> resident_pages;
+	return resident_pages * sysconf(_SC_PAGESIZE) / (1024 * 1024);
+#endif
+}
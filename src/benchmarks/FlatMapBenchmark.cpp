@@ -0,0 +1,56 @@
+// Lookup-heavy and bulk-load comparison of FlatMap against std::map and std::unordered_map.
+
+#include <iostream>
+#include <map>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include "../flat/FlatMap.h"
+#include "BenchmarkUtils.h"
+
+using namespace std;
+
+const size_t key_count = 1'000'000;
+const size_t lookup_count = 10'000'000;
+
+template<typename Map>
+size_t lookup_all(const Map& map, const vector<int>& probes)
+{
+	size_t found = 0;
+	for (int key : probes)
+		found += map.count(key);
+	return found;
+}
+
+int main()
+{
+	mt19937 gen(42);
+	uniform_int_distribution<int> dist(0, static_cast<int>(key_count) * 4);
+
+	vector<pair<int, int>> input(key_count);
+	for (auto& kv : input)
+		kv = { dist(gen), 1 };
+
+	vector<int> probes(lookup_count);
+	for (auto& key : probes)
+		key = dist(gen);
+
+	map<int, int> tree;
+	unordered_map<int, int> hash;
+	FlatMap<int, int> flat;
+	size_t checksum = 0;
+
+	cout << "Bulk load of " << key_count << " keys" << endl;
+	cout << "  std::map:           " << measure_ms([&] { tree.insert(input.begin(), input.end()); }) << " ms" << endl;
+	cout << "  std::unordered_map: " << measure_ms([&] { hash.insert(input.begin(), input.end()); }) << " ms" << endl;
+	cout << "  FlatMap:            " << measure_ms([&] { flat.insert_range(input.data(), input.data() + input.size()); }) << " ms" << endl;
+
+	cout << "Lookup of " << lookup_count << " random keys" << endl;
+	cout << "  std::map:           " << measure_ms([&] { checksum += lookup_all(tree, probes); }) << " ms" << endl;
+	cout << "  std::unordered_map: " << measure_ms([&] { checksum += lookup_all(hash, probes); }) << " ms" << endl;
+	cout << "  FlatMap:            " << measure_ms([&] { checksum += lookup_all(flat, probes); }) << " ms" << endl;
+	flat.build_index();
+	cout << "  FlatMap + index:    " << measure_ms([&] { checksum += lookup_all(flat, probes); }) << " ms" << endl;
+
+	cout << "Checksum: " << checksum << endl;
+}
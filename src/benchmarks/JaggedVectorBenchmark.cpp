@@ -0,0 +1,80 @@
+// Build time, memory and full-scan speed of JaggedVector against a nested Vector<Vector<int>>.
+
+#include <iostream>
+#include <random>
+#include "../jagged/JaggedVector.h"
+#include "BenchmarkUtils.h"
+
+using namespace std;
+
+const size_t row_count = 2'000'000;
+const size_t max_row_size = 16;
+
+int main()
+{
+	mt19937 gen(42);
+	uniform_int_distribution<size_t> row_size(0, max_row_size);
+
+	// Source rows, one after another, so both containers are built from the same ranges
+	Vector<size_t> sizes;
+	Vector<int> source;
+	for (size_t row = 0; row < row_count; ++row)
+	{
+		sizes.push_back(row_size(gen));
+		for (size_t i = 0; i < sizes[row]; ++i)
+			source.push_back(static_cast<int>(gen()));
+	}
+
+	// The outer Vector is reserved up front, so it never has to move the rows around
+	Vector<Vector<int>> nested;
+	JaggedVector<int> jagged;
+	long long checksum = 0;
+
+	const double nested_build = measure_ms([&] {
+		nested.reserve(row_count);
+		const int* row_it = source.data();
+		for (size_t row = 0; row < row_count; ++row)
+		{
+			nested.emplace_back(row_it, row_it + sizes[row]);
+			row_it += sizes[row];
+		}
+	});
+	const double jagged_build = measure_ms([&] {
+		jagged.reserve(row_count, source.size());
+		const int* row_it = source.data();
+		for (size_t row = 0; row < row_count; ++row)
+		{
+			jagged.push_row(row_it, row_it + sizes[row]);
+			row_it += sizes[row];
+		}
+	});
+
+	const double nested_scan = measure_ms([&] {
+		for (size_t row = 0; row < nested.size(); ++row)
+			for (const int val : nested[row])
+				checksum += val;
+	});
+	const double jagged_scan = measure_ms([&] {
+		for (size_t row = 0; row < jagged.size(); ++row)
+			for (const int val : jagged.crow(row))
+				checksum += val;
+	});
+
+	// Allocated capacity on both sides. Not counted: the allocator's own header on every heap allocation
+	size_t nested_bytes = nested.capacity() * sizeof(Vector<int>);
+	for (size_t row = 0; row < nested.size(); ++row)
+		nested_bytes += nested[row].capacity() * sizeof(int);
+	const size_t jagged_bytes = jagged.allocated_bytes();
+
+	cout << row_count << " rows, " << source.size() << " elements" << endl;
+	cout << "Build" << endl;
+	cout << "  Vector<Vector<int>>: " << nested_build << " ms, " << row_count + 1 << " allocations" << endl;
+	cout << "  JaggedVector<int>:   " << jagged_build << " ms, 2 allocations" << endl;
+	cout << "Memory" << endl;
+	cout << "  Vector<Vector<int>>: " << nested_bytes / (1024 * 1024) << " MB" << endl;
+	cout << "  JaggedVector<int>:   " << jagged_bytes / (1024 * 1024) << " MB" << endl;
+	cout << "Full scan" << endl;
+	cout << "  Vector<Vector<int>>: " << nested_scan << " ms" << endl;
+	cout << "  JaggedVector<int>:   " << jagged_scan << " ms" << endl;
+	cout << "Checksum: " << checksum << endl;
+}
@@ -0,0 +1,42 @@
+// RSS over time for a spike-then-drain workload, with and without the Vector shrink policy.
+
+#include <iostream>
+#include "../vector/Vector.h"
+#include "BenchmarkUtils.h"
+
+using namespace std;
+
+const size_t spike_size = 64'000'000;
+const size_t drain_steps = 8;
+
+void spike_then_drain(bool use_policy)
+{
+	cout << (use_policy ? "With shrink policy" : "Without shrink policy") << endl;
+
+	Vector<int> vec;
+	Vector<int>::ShrinkPolicy policy;
+	policy.enabled = use_policy;
+	vec.set_shrink_policy(policy);
+
+	for (size_t i = 0; i < spike_size; ++i)
+		vec.push_back(static_cast<int>(i));
+	cout << "  spike:    size " << vec.size() << ", capacity " << vec.capacity() << ", RSS " << resident_mb() << " MB" << endl;
+
+	// Draining in steps, every step halves the size
+	for (size_t step = 0; step < drain_steps; ++step)
+	{
+		const size_t target = vec.size() / 2;
+		while (vec.size() > target)
+			vec.pop_back();
+		cout << "  drain " << step + 1 << ":  size " << vec.size() << ", capacity " << vec.capacity() << ", RSS " << resident_mb() << " MB" << endl;
+	}
+
+	cout << "  returned " << vec.memory_returned() / (1024 * 1024) << " MB" << endl;
+	cout << "  trim(0) returned " << vec.trim(0) / (1024 * 1024) << " MB more, RSS " << resident_mb() << " MB" << endl;
+}
+
+int main()
+{
+	spike_then_drain(false);
+	spike_then_drain(true);
+}
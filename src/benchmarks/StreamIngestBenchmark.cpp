@@ -0,0 +1,118 @@
+// Ingesting 100M integers from single pass sources: a push_back loop against the streaming constructor
+// (chunked staging) and the range constructor with a size hint.
+
+#include <iostream>
+#include <istream>
+#include <iterator>
+#include <streambuf>
+#include <string>
+#include "../vector/Vector.h"
+#include "BenchmarkUtils.h"
+
+using namespace std;
+
+// Writes "0 1 2 ... count-1 " into a small buffer on demand, so the 100M numbers never have to sit in memory as text
+class NumberStreamBuf : public streambuf
+{
+private:
+	size_t next = 0;
+	size_t count = 0;
+	string buffer;
+protected:
+	int_type underflow() override
+	{
+		if (next == count)
+			return traits_type::eof();
+
+		buffer.clear();
+		for (size_t i = 0; i < 4096 && next < count; ++i, ++next)
+		{
+			buffer += to_string(next);
+			buffer += ' ';
+		}
+
+		setg(buffer.data(), buffer.data(), buffer.data() + buffer.size());
+		return traits_type::to_int_type(buffer[0]);
+	}
+public:
+	explicit NumberStreamBuf(size_t cnt) : count(cnt) {}
+};
+
+// Input-only source without any parsing, it stands in for a socket reader or a generator
+class CountingInput
+{
+public:
+	class Iter
+	{
+	public:
+		using iterator_category = input_iterator_tag;
+		using value_type = int;
+		using difference_type = ptrdiff_t;
+		using pointer = const int*;
+		using reference = int;
+		size_t pos;
+		int operator*() const { return static_cast<int>(pos); }
+		Iter& operator++() { ++pos; return *this; }
+		bool operator==(const Iter& rhs) const { return pos == rhs.pos; }
+		bool operator!=(const Iter& rhs) const { return pos != rhs.pos; }
+	};
+private:
+	size_t count;
+public:
+	explicit CountingInput(size_t cnt) : count(cnt) {}
+	Iter begin() const { return Iter{ 0 }; }
+	Iter end() const { return Iter{ count }; }
+};
+
+// Same source, but it knows how many values are coming
+class HintedCountingInput : public CountingInput
+{
+private:
+	size_t count;
+public:
+	explicit HintedCountingInput(size_t cnt) : CountingInput(cnt), count(cnt) {}
+	size_t size_hint() const { return count; }
+};
+
+template<typename Func>
+void measure(const char* name, Func func)
+{
+	size_t size = 0;
+	size_t capacity = 0;
+	const double ms = measure_ms([&] {
+		const Vector<int> vec = func();
+		size = vec.size();
+		capacity = vec.capacity();
+	});
+	cout << "  " << name << ms << " ms, size " << size << ", capacity " << capacity << endl;
+}
+
+int main(int argc, char** argv)
+{
+	const size_t count = argc > 1 ? stoull(argv[1]) : 100'000'000;
+
+	cout << "Generator source, " << count << " integers" << endl;
+	measure("push_back loop:      ", [&] {
+		Vector<int> vec;
+		for (const int val : CountingInput(count))
+			vec.push_back(val);
+		return vec;
+	});
+	measure("input iterators:     ", [&] { CountingInput src(count); return Vector<int>(src.begin(), src.end()); });
+	measure("range + size hint:   ", [&] { return Vector<int>(from_range_tag, HintedCountingInput(count)); });
+
+	cout << "istream source, " << count << " integers" << endl;
+	measure("push_back loop:      ", [&] {
+		NumberStreamBuf buf(count);
+		istream in(&buf);
+		Vector<int> vec;
+		for (istream_iterator<int> it(in), end; it != end; ++it)
+			vec.push_back(*it);
+		return vec;
+	});
+	measure("istream_iterator:    ", [&] {
+		NumberStreamBuf buf(count);
+		istream in(&buf);
+		return Vector<int>(istream_iterator<int>(in), istream_iterator<int>());
+	});
+}
@@ -16,6 +16,12 @@ namespace err
 	const char* const diff_vectors = "Iterators are from different Vectors!";
 	const char* const traversed_vector = "Vector traversed!";
 	const char* const subscript_out_of_range = "Vector subscript out of range!";
+	const char* const view_out_of_range = "View range out of the Vector!";
+	const char* const adopt_size_over_capacity = "Adopted size is bigger than the adopted capacity!";
+	const char* const row_out_of_range = "JaggedVector row out of range!";
+	const char* const row_truncate_grows = "truncate_row() cannot make a row bigger!";
+	const char* const bad_shrink_policy = "Shrink policy needs shrink_below > 0, keep_headroom >= 1 and shrink_below * keep_headroom < 1!";
+	const char* const key_not_found = "Key not found in FlatMap!";
 
 	void exit_if(bool cnd, const char* msg);
 }
\ No newline at end of file
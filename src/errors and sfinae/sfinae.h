@@ -15,6 +15,9 @@ using require_bidirectional_it = std::enable_if_t<std::is_base_of_v<std::bidirec
 template<typename Iter>
 using require_random_access_it = std::enable_if_t<std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<Iter>::iterator_category>>;
 
+template<typename Iter>
+constexpr bool is_forward_it_v = std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<Iter>::iterator_category>;
+
 template<typename Iter>
 using is_random_access_it = std::enable_if_t<std::is_same_v<std::random_access_iterator_tag, typename std::iterator_traits<Iter>::iterator_category>>;
 
@@ -22,4 +25,21 @@ template<typename Iter>
 using is_not_random_access_it = std::enable_if_t<!std::is_same_v<std::random_access_iterator_tag, typename std::iterator_traits<Iter>::iterator_category>>;
 
 template<bool TEST, typename Type>
-using const_T_or_nonconst_T = std::conditional_t<TEST, const Type, Type>;
\ No newline at end of file
+using const_T_or_nonconst_T = std::conditional_t<TEST, const Type, Type>;
+
+// A source can report how many values it will produce, either through size() or through size_hint() when it only knows an estimate
+template<typename Range, typename = void>
+struct has_size_hint : std::false_type {};
+
+template<typename Range>
+struct has_size_hint<Range, std::void_t<decltype(std::declval<const Range&>().size_hint())>> : std::true_type {};
+
+template<typename Range, typename = void>
+struct has_size : std::false_type {};
+
+template<typename Range>
+struct has_size<Range, std::void_t<decltype(std::declval<const Range&>().size())>> : std::true_type {};
+
+// True when either of the above is there
+template<typename Range>
+constexpr bool reports_size_v = has_size_hint<std::remove_reference_t<Range>>::value || has_size<std::remove_reference_t<Range>>::value;
\ No newline at end of file
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <utility>
+#include "SortedVector.h"
+
+// Orders the stored pairs by key only, and lets the lookups compare a pair against a bare key (the search index keeps bare keys)
+template<typename K, typename V, typename Compare>
+struct FlatMapKeyCompare
+{
+	Compare comp;
+	bool operator()(const K& lhs, const K& rhs) const { return comp(lhs, rhs); }
+	bool operator()(const std::pair<K, V>& lhs, const std::pair<K, V>& rhs) const { return comp(lhs.first, rhs.first); }
+	bool operator()(const std::pair<K, V>& lhs, const K& rhs) const { return comp(lhs.first, rhs); }
+	bool operator()(const K& lhs, const std::pair<K, V>& rhs) const { return comp(lhs, rhs.first); }
+};
+
+template<typename K, typename V>
+struct FlatMapKeyOf
+{
+	const K& operator()(const std::pair<K, V>& val) const noexcept { return val.first; }
+};
+
+// Sorted key-value pairs in a single Vector, a drop-in for std::map on read-mostly data.
+// Iterators hand out mutable pairs so the values can be changed in place. Changing a key breaks the order, don't do that
+template<typename K, typename V, typename Compare = std::less<K>>
+class FlatMap : protected SortedVector<std::pair<K, V>, FlatMapKeyCompare<K, V, Compare>, FlatMapKeyOf<K, V>>
+{
+public:
+	using value_type = std::pair<K, V>;
+private:
+	using Base = SortedVector<value_type, FlatMapKeyCompare<K, V, Compare>, FlatMapKeyOf<K, V>>;
+public:
+	using Iterator = typename Vector<value_type>::Iterator;
+	using typename Base::ConstIterator;
+public:
+	FlatMap() noexcept = default;
+	FlatMap(const std::initializer_list<value_type>& init) noexcept { insert_range(init.begin(), init.end()); }
+	template<typename Iter> FlatMap(Iter it1, Iter it2, require_forward_it<Iter>* = nullptr) noexcept { insert_range(it1, it2); }
+	Iterator insert(const value_type& val) noexcept { return Base::elements.begin() + Base::insert_value(val, true); }
+	template<typename Iter> void insert_range(Iter it1, Iter it2, require_forward_it<Iter>* = nullptr) noexcept { Base::insert_batch(it1, it2, true); }
+	V& operator[](const K& key) noexcept;
+	V& at(const K& key) const noexcept;
+	Iterator find(const K& key) const noexcept;
+	size_t erase(const K& key) noexcept { return Base::erase(key); }
+	size_t count(const K& key) const noexcept { return Base::contains(key); }
+	bool contains(const K& key) const noexcept { return Base::contains(key); }
+	ConstIterator lower_bound(const K& key) const noexcept { return Base::lower_bound(key); }
+	ConstIterator upper_bound(const K& key) const noexcept { return Base::upper_bound(key); }
+	using Base::size;
+	using Base::capacity;
+	using Base::empty;
+	using Base::reserve;
+	using Base::clear;
+	using Base::build_index;
+	using Base::has_index;
+	using Base::cbegin;
+	using Base::cend;
+	Iterator begin() const noexcept { return Base::elements.begin(); }
+	Iterator end() const noexcept { return Base::elements.end(); }
+};
+
+template<typename K, typename V, typename Compare>
+V& FlatMap<K, V, Compare>::operator[](const K& key) noexcept
+{
+	const size_t pos = Base::lower_bound_index(key);
+
+	if (!Base::is_equivalent(pos, key))
+	{
+		Base::mark_dirty();
+		Base::elements.insert(Base::elements.cbegin() + pos, value_type(key, V()));
+	}
+	return Base::elements.data()[pos].second;
+}
+
+template<typename K, typename V, typename Compare>
+V& FlatMap<K, V, Compare>::at(const K& key) const noexcept
+{
+	const size_t pos = Base::lower_bound_index(key);
+	err::exit_if(!Base::is_equivalent(pos, key), err::key_not_found);
+	return Base::elements.data()[pos].second;
+}
+
+template<typename K, typename V, typename Compare>
+typename FlatMap<K, V, Compare>::Iterator FlatMap<K, V, Compare>::find(const K& key) const noexcept
+{
+	const size_t pos = Base::lower_bound_index(key);
+	return Base::is_equivalent(pos, key) ? begin() + pos : end();
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "SortedVector.h"
+
+// SortedVector with unique values, a drop-in for std::set on read-mostly data
+template<typename T, typename Compare = std::less<T>>
+class FlatSet : protected SortedVector<T, Compare>
+{
+private:
+	using Base = SortedVector<T, Compare>;
+public:
+	using typename Base::ConstIterator;
+public:
+	FlatSet() noexcept = default;
+	explicit FlatSet(const Compare& cmp) noexcept : Base(cmp) {}
+	FlatSet(const std::initializer_list<T>& init) noexcept { insert_range(init.begin(), init.end()); }
+	template<typename Iter> FlatSet(Iter it1, Iter it2, require_forward_it<Iter>* = nullptr) noexcept { insert_range(it1, it2); }
+	ConstIterator insert(const T& val) noexcept { return Base::cbegin() + Base::insert_value(val, true); }
+	template<typename Iter> void insert_range(Iter it1, Iter it2, require_forward_it<Iter>* = nullptr) noexcept { Base::insert_batch(it1, it2, true); }
+	using Base::size;
+	using Base::capacity;
+	using Base::empty;
+	using Base::data;
+	using Base::operator[];
+	using Base::reserve;
+	using Base::clear;
+	using Base::erase;
+	using Base::find;
+	using Base::lower_bound;
+	using Base::upper_bound;
+	using Base::count;
+	using Base::contains;
+	using Base::build_index;
+	using Base::has_index;
+	using Base::begin;
+	using Base::end;
+	using Base::cbegin;
+	using Base::cend;
+};
@@ -0,0 +1,338 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include "../vector/Vector.h"
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SORTED_VECTOR_PREFETCH(addr) __builtin_prefetch(addr)
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#define SORTED_VECTOR_PREFETCH(addr) _mm_prefetch(reinterpret_cast<const char*>(addr), _MM_HINT_T0)
+#else
+#define SORTED_VECTOR_PREFETCH(addr)
+#endif
+
+// Default projection for the search index, the whole value is the key
+struct IdentityKey
+{
+	template<typename U> const U& operator()(const U& val) const noexcept { return val; }
+};
+
+// A sorted sequence kept in a single Vector, so lookups walk contiguous memory instead of chasing tree nodes.
+// Duplicates are allowed (multiset-like). FlatSet and FlatMap are built on top of it.
+// KeyOf picks the part of a value that the search index keeps, Compare has to accept it on both sides
+template<typename T, typename Compare = std::less<T>, typename KeyOf = IdentityKey>
+class SortedVector
+{
+public:
+	using ConstIterator = typename Vector<T>::ConstIterator;
+	using IndexKey = std::decay_t<decltype(std::declval<const KeyOf&>()(std::declval<const T&>()))>;
+protected:
+	Vector<T> elements;
+	Compare comp;
+	KeyOf key_of;
+
+	// Optional Eytzinger (BFS) layout of the keys, 1-based. index_rank maps a slot back to its position in elements
+	Vector<IndexKey> index;
+	Vector<size_t> index_rank;
+	bool index_fresh = false;
+protected:
+	template<typename Key> size_t lower_bound_index(const Key& key) const noexcept;
+	template<typename Key> size_t upper_bound_index(const Key& key) const noexcept;
+	template<typename Key> size_t eytzinger_lower_bound_slot(const Key& key) const noexcept;
+	template<typename Key> bool is_equivalent(size_t pos, const Key& key) const noexcept { return pos != elements.size() && !comp(key, elements.data()[pos]); }
+	size_t fill_index(size_t pos, size_t slot) noexcept;
+	size_t insert_value(const T& val, bool unique) noexcept;
+	template<typename Iter> void insert_batch(Iter it1, Iter it2, bool unique) noexcept;
+	void merge_sorted_batch(Vector<T>& batch, bool unique) noexcept;
+	void mark_dirty() noexcept { index_fresh = false; }
+public:
+	SortedVector() noexcept = default;
+	explicit SortedVector(const Compare& cmp) noexcept : comp(cmp) {}
+	SortedVector(const std::initializer_list<T>& init) noexcept { insert_range(init.begin(), init.end()); }
+	template<typename Iter> SortedVector(Iter it1, Iter it2, require_forward_it<Iter>* = nullptr) noexcept { insert_range(it1, it2); }
+	size_t size() const noexcept { return elements.size(); }
+	size_t capacity() const noexcept { return elements.capacity(); }
+	bool empty() const noexcept { return elements.empty(); }
+	const T* data() const noexcept { return elements.data(); }
+	const T& operator[](size_t pos) const noexcept { return elements[pos]; }
+	void reserve(const size_t new_cap) noexcept { elements.reserve(new_cap); }
+	void clear() noexcept;
+	ConstIterator insert(const T& val) noexcept { return elements.cbegin() + insert_value(val, false); }
+	template<typename Iter> void insert_range(Iter it1, Iter it2, require_forward_it<Iter>* = nullptr) noexcept { insert_batch(it1, it2, false); }
+	template<typename Key> size_t erase(const Key& key) noexcept;
+	template<typename Key> ConstIterator find(const Key& key) const noexcept;
+	template<typename Key> ConstIterator lower_bound(const Key& key) const noexcept { return cbegin() + lower_bound_index(key); }
+	template<typename Key> ConstIterator upper_bound(const Key& key) const noexcept { return cbegin() + upper_bound_index(key); }
+	template<typename Key> size_t count(const Key& key) const noexcept { return upper_bound_index(key) - lower_bound_index(key); }
+	template<typename Key> bool contains(const Key& key) const noexcept;
+	void build_index() noexcept;
+	bool has_index() const noexcept { return index_fresh; }
+	ConstIterator begin() const noexcept { return elements.cbegin(); }
+	ConstIterator end() const noexcept { return elements.cend(); }
+	ConstIterator cbegin() const noexcept { return elements.cbegin(); }
+	ConstIterator cend() const noexcept { return elements.cend(); }
+};
+
+template<typename T, typename Compare, typename KeyOf>
+template<typename Key>
+size_t SortedVector<T, Compare, KeyOf>::lower_bound_index(const Key& key) const noexcept
+{
+	if (index_fresh)
+	{
+		const size_t slot = eytzinger_lower_bound_slot(key);
+		return slot == 0 ? elements.size() : index_rank[slot];
+	}
+
+	const T* const first = elements.data();
+	const T* base = first;
+	size_t len = elements.size();
+
+	if (len == 0)
+		return 0;
+
+	// Branchless binary search: the loop count only depends on the size, the comparison just picks the next base (cmov)
+	while (len > 1)
+	{
+		const size_t half = len / 2;
+		base = comp(base[half], key) ? base + half : base;
+		len -= half;
+	}
+
+	return (base - first) + comp(*base, key);
+}
+
+template<typename T, typename Compare, typename KeyOf>
+template<typename Key>
+size_t SortedVector<T, Compare, KeyOf>::upper_bound_index(const Key& key) const noexcept
+{
+	const T* const first = elements.data();
+	const T* base = first;
+	size_t len = elements.size();
+
+	if (len == 0)
+		return 0;
+
+	// Same as above, just with the comparison flipped
+	while (len > 1)
+	{
+		const size_t half = len / 2;
+		base = comp(key, base[half]) ? base : base + half;
+		len -= half;
+	}
+
+	return (base - first) + !comp(key, *base);
+}
+
+template<typename T, typename Compare, typename KeyOf>
+template<typename Key>
+size_t SortedVector<T, Compare, KeyOf>::eytzinger_lower_bound_slot(const Key& key) const noexcept
+{
+	const IndexKey* const slots = index.data();
+	const size_t len = elements.size();
+	size_t slot = 1;
+
+	// Going down the implicit tree, left child is 2k and right child is 2k + 1.
+	// The 16 descendants four levels down sit next to each other, so they can be fetched ahead of time
+	while (slot <= len)
+	{
+		// Near the bottom of the tree this is past the end of the index. Prefetching can't fault, but such a pointer would be UB, hence the integer math
+		const std::uintptr_t ahead = reinterpret_cast<std::uintptr_t>(slots) + 16 * slot * sizeof(IndexKey);
+		SORTED_VECTOR_PREFETCH(reinterpret_cast<const IndexKey*>(ahead));
+		slot = 2 * slot + comp(slots[slot], key);
+	}
+
+	// Every right turn added a trailing 1 bit. Dropping them (plus the last left turn) gives the answer's slot
+	while (slot & 1)
+		slot >>= 1;
+	slot >>= 1;
+
+	return slot; // 0 means that every element is lower than the key
+}
+
+template<typename T, typename Compare, typename KeyOf>
+template<typename Key>
+bool SortedVector<T, Compare, KeyOf>::contains(const Key& key) const noexcept
+{
+	if (!index_fresh)
+		return is_equivalent(lower_bound_index(key), key);
+
+	// Checking the slot itself saves a trip to index_rank and elements, which are both likely cache misses
+	const size_t slot = eytzinger_lower_bound_slot(key);
+	return slot != 0 && !comp(key, index.data()[slot]);
+}
+
+template<typename T, typename Compare, typename KeyOf>
+size_t SortedVector<T, Compare, KeyOf>::fill_index(size_t pos, size_t slot) noexcept
+{
+	// In-order walk over the implicit tree hands out the sorted elements one by one
+	if (slot <= elements.size())
+	{
+		pos = fill_index(pos, 2 * slot);
+		index[slot] = key_of(elements[pos]);
+		index_rank[slot] = pos++;
+		pos = fill_index(pos, 2 * slot + 1);
+	}
+	return pos;
+}
+
+template<typename T, typename Compare, typename KeyOf>
+void SortedVector<T, Compare, KeyOf>::build_index() noexcept
+{
+	// Slot 0 is unused, that's why there's one more
+	index.clear();
+	index.resize(elements.size() + 1, IndexKey());
+	index_rank.clear();
+	index_rank.resize(elements.size() + 1, 0);
+
+	fill_index(0, 1);
+	index_fresh = true;
+}
+
+template<typename T, typename Compare, typename KeyOf>
+size_t SortedVector<T, Compare, KeyOf>::insert_value(const T& val, bool unique) noexcept
+{
+	mark_dirty();
+
+	if (unique)
+	{
+		const size_t pos = lower_bound_index(val);
+		if (!is_equivalent(pos, val))
+			elements.insert(elements.cbegin() + pos, val);
+		return pos;
+	}
+
+	// Equal values go after the existing ones, just like the multiset does it
+	const size_t pos = upper_bound_index(val);
+	elements.insert(elements.cbegin() + pos, val);
+	return pos;
+}
+
+template<typename T, typename Compare, typename KeyOf>
+template<typename Iter>
+void SortedVector<T, Compare, KeyOf>::insert_batch(Iter it1, Iter it2, bool unique) noexcept
+{
+	mark_dirty();
+
+	Vector<T> batch(it1, it2);
+	T* const first = batch.data();
+	const size_t len = batch.size();
+
+	if (len == 0)
+		return;
+
+	std::stable_sort(first, first + len, comp);
+
+	if (unique)
+	{
+		// Drop duplicates inside the batch, the values that are already stored are dropped by the merge
+		size_t kept = 1;
+		for (size_t i = 1; i < len; ++i)
+		{
+			if (!comp(first[kept - 1], first[i]))
+				continue;
+
+			if (kept != i)
+				first[kept] = std::move(first[i]);
+			++kept;
+		}
+
+		while (batch.size() > kept)
+			batch.pop_back();
+	}
+
+	merge_sorted_batch(batch, unique);
+}
+
+template<typename T, typename Compare, typename KeyOf>
+void SortedVector<T, Compare, KeyOf>::merge_sorted_batch(Vector<T>& batch, bool unique) noexcept
+{
+	const size_t batch_size = batch.size();
+
+	if (batch_size == 0)
+		return;
+
+	// Growing the storage first means the existing elements stay where they are and the merge below can fill it from the back
+	// without ever overwriting an unread element. The slots past the old size are raw memory that Vector doesn't hand out,
+	// so the buffer is taken over for the merge and given back with the final size
+	const size_t old_size = elements.size();
+	const size_t new_end = old_size + batch_size;
+	elements.reserve(new_end);
+	const auto buffer = elements.release();
+
+	T* const out = buffer.ptr;
+	T* const in = batch.data();
+	size_t old_pos = old_size;
+	size_t batch_pos = batch_size;
+	size_t out_pos = new_end;
+
+	// Slots between the old size and the merged part hold no object yet, those are constructed instead of assigned
+	auto place = [&](size_t pos, T& val) {
+		if (pos >= old_size && pos < out_pos)
+			new (&out[pos]) T(std::move(val));
+		else
+			out[pos] = std::move(val);
+	};
+
+	// Stops as soon as the batch is used up, the prefix smaller than the batch is never touched.
+	// The batch is a temporary, so its values are moved out instead of copied
+	while (batch_pos > 0)
+	{
+		if (old_pos > 0 && comp(in[batch_pos - 1], out[old_pos - 1]))
+			place(out_pos - 1, out[--old_pos]);
+		else if (unique && old_pos > 0 && !comp(out[old_pos - 1], in[batch_pos - 1]))
+		{
+			--batch_pos; // Already stored
+			continue;
+		}
+		else
+			place(out_pos - 1, in[--batch_pos]);
+		--out_pos;
+	}
+
+	// Every dropped value left a hole between the untouched prefix and the merged part
+	const size_t gap = out_pos - old_pos;
+	if (gap != 0)
+	{
+		for (size_t i = out_pos; i < new_end; ++i)
+			place(i - gap, out[i]);
+
+		// The last gap slots are moved-from now, unless they never held an object
+		for (size_t i = new_end - gap; i < new_end; ++i)
+			if (i < old_size || i >= out_pos)
+				out[i].~T();
+	}
+
+	elements.adopt(out, new_end - gap, buffer.capacity, buffer.deleter);
+}
+
+template<typename T, typename Compare, typename KeyOf>
+template<typename Key>
+size_t SortedVector<T, Compare, KeyOf>::erase(const Key& key) noexcept
+{
+	const size_t first = lower_bound_index(key);
+	const size_t last = upper_bound_index(key);
+
+	if (first != last)
+	{
+		mark_dirty();
+		elements.erase(elements.begin() + first, elements.begin() + last);
+	}
+	return last - first;
+}
+
+template<typename T, typename Compare, typename KeyOf>
+template<typename Key>
+typename SortedVector<T, Compare, KeyOf>::ConstIterator SortedVector<T, Compare, KeyOf>::find(const Key& key) const noexcept
+{
+	const size_t pos = lower_bound_index(key);
+	return is_equivalent(pos, key) ? cbegin() + pos : cend();
+}
+
+template<typename T, typename Compare, typename KeyOf>
+void SortedVector<T, Compare, KeyOf>::clear() noexcept
+{
+	mark_dirty();
+	elements.clear();
+}
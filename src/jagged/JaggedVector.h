@@ -0,0 +1,163 @@
+#pragma once
+
+#include <initializer_list>
+#include "../vector/Vector.h"
+
+// Vector of rows (CSR layout): the elements of all rows live in one Vector, and n + 1 offsets mark where every row starts
+// (8 bytes per row). Rows can only be added at the back. truncate_row() works in place and records the unused tail of the row
+// in row_slack, which takes no memory until the first truncation. compact() packs the rows together again and drops it
+template<typename T>
+class JaggedVector
+{
+private:
+	Vector<T> values;
+	Vector<size_t> offsets; // Row i takes [offsets[i], offsets[i + 1]) in values, the last offset is always values.size()
+	Vector<size_t> row_slack; // Empty, or the unused tail of every row
+	size_t live_size = 0;
+private:
+	size_t row_begin(size_t row) const noexcept { return offsets.data()[row]; }
+	size_t row_end(size_t row) const noexcept { return offsets.data()[row + 1] - (row_slack.empty() ? 0 : row_slack.data()[row]); }
+	void check_row(size_t row) const noexcept { err::exit_if(row >= size(), err::row_out_of_range); }
+public:
+	JaggedVector() noexcept = default;
+	size_t size() const noexcept { return offsets.empty() ? 0 : offsets.size() - 1; }
+	size_t total_size() const noexcept { return live_size; }
+	size_t slack() const noexcept { return values.size() - live_size; }
+	size_t allocated_bytes() const noexcept { return values.capacity() * sizeof(T) + (offsets.capacity() + row_slack.capacity()) * sizeof(size_t); }
+	bool empty() const noexcept { return size() == 0; }
+	size_t row_size(size_t row) const noexcept { check_row(row); return row_end(row) - row_begin(row); }
+	void reserve(const size_t rows, const size_t elements) noexcept { offsets.reserve(rows + 1); values.reserve(elements); }
+	template<typename Iter> void push_row(Iter it1, Iter it2, require_forward_it<Iter>* = nullptr) noexcept;
+	template<typename Range> void push_row(const Range& range) noexcept { push_row(std::begin(range), std::end(range)); }
+	void push_row(const std::initializer_list<T>& init) noexcept { push_row(init.begin(), init.end()); }
+	void push_back(const T& val) noexcept;
+	void pop_row() noexcept;
+	void truncate_row(size_t row, const size_t new_size) noexcept;
+	void compact() noexcept;
+	void shrink_to_fit() noexcept;
+	void clear() noexcept;
+	VectorView<T> row(size_t row) const noexcept { check_row(row); return values.view(row_begin(row), row_end(row) - row_begin(row)); }
+	VectorView<const T> crow(size_t row) const noexcept { check_row(row); return values.cview(row_begin(row), row_end(row) - row_begin(row)); }
+	VectorView<T> operator[](size_t row) const noexcept { return this->row(row); }
+	VectorView<T> back() const noexcept { err::exit_if(empty(), err::back_empty_vector); return row(size() - 1); }
+};
+
+template<typename T>
+template<typename Iter>
+void JaggedVector<T>::push_row(Iter it1, Iter it2, require_forward_it<Iter>*) noexcept
+{
+	// The range must not come from this JaggedVector, growing the values would leave it dangling
+	const size_t begin = values.size();
+	values.insert(values.cend(), it1, it2);
+
+	if (offsets.empty())
+		offsets.push_back(0);
+	offsets.push_back(values.size());
+
+	if (!row_slack.empty())
+		row_slack.push_back(0);
+
+	live_size += values.size() - begin;
+}
+
+template<typename T>
+void JaggedVector<T>::push_back(const T& val) noexcept
+{
+	err::exit_if(empty(), err::back_empty_vector);
+
+	// A truncated last row gets its slack back before the values grow
+	const size_t last = size() - 1;
+	if (!row_slack.empty() && row_slack.data()[last] > 0)
+	{
+		values.data()[row_end(last)] = val;
+		--row_slack.data()[last];
+	}
+	else
+	{
+		values.push_back(val);
+		++offsets.data()[last + 1];
+	}
+
+	++live_size;
+}
+
+template<typename T>
+void JaggedVector<T>::pop_row() noexcept
+{
+	err::exit_if(empty(), err::pop_empty_vector);
+
+	const size_t last = size() - 1;
+	const size_t begin = row_begin(last);
+	live_size -= row_end(last) - begin;
+
+	offsets.pop_back();
+	if (!row_slack.empty())
+		row_slack.pop_back();
+
+	// The last row is at the end of the values, so it goes away completely instead of turning into slack
+	while (values.size() > begin)
+		values.pop_back();
+}
+
+template<typename T>
+void JaggedVector<T>::truncate_row(size_t row, const size_t new_size) noexcept
+{
+	check_row(row);
+	err::exit_if(new_size > row_end(row) - row_begin(row), err::row_truncate_grows);
+
+	if (row_slack.empty())
+		row_slack.resize(size(), 0);
+
+	const size_t removed = row_end(row) - row_begin(row) - new_size;
+	row_slack.data()[row] += removed;
+	live_size -= removed;
+}
+
+template<typename T>
+void JaggedVector<T>::compact() noexcept
+{
+	if (slack() != 0)
+	{
+		T* const elements = values.data();
+		size_t* const bounds = offsets.data();
+		const size_t rows = size();
+		size_t write = 0;
+
+		// Rows are stored in order, so moving every row down can never overwrite a row that hasn't been moved yet
+		for (size_t row = 0; row < rows; ++row)
+		{
+			const size_t begin = bounds[row];
+			const size_t end = row_end(row); // Before bounds[row + 1] gets overwritten
+
+			if (begin != write)
+				for (size_t i = begin; i < end; ++i)
+					elements[write + i - begin] = std::move(elements[i]);
+
+			bounds[row] = write;
+			write += end - begin;
+		}
+		bounds[rows] = write;
+
+		while (values.size() > write)
+			values.pop_back();
+	}
+
+	row_slack.clear();
+}
+
+template<typename T>
+void JaggedVector<T>::shrink_to_fit() noexcept
+{
+	compact();
+	values.shrink_to_fit();
+	offsets.shrink_to_fit();
+}
+
+template<typename T>
+void JaggedVector<T>::clear() noexcept
+{
+	values.clear();
+	offsets.clear();
+	row_slack.clear();
+	live_size = 0;
+}
@@ -1,6 +1,15 @@
 #include<iostream>
 #include<vector>
+#include<set>
+#include<map>
+#include<random>
+#include<sstream>
+#include<iterator>
+#include<string>
 #include "vector/Vector.h"
+#include "flat/FlatSet.h"
+#include "flat/FlatMap.h"
+#include "jagged/JaggedVector.h"
 
 using namespace std;
 
@@ -69,6 +78,383 @@ public:
 	}
 };
 
+// Random batches and single inserts/erases, then every lookup is compared against std::multiset/std::set/std::map,
+// once with the branchless binary search and once with the Eytzinger index
+bool flat_containers_match()
+{
+	mt19937 gen(2021);
+	bool ok = true;
+
+	for (int round = 0; round < 100; ++round)
+	{
+		multiset<int> ref_multi;
+		set<int> ref_set;
+		map<int, int> ref_map;
+		SortedVector<int> multi;
+		FlatSet<int> flat_set;
+		FlatMap<int, int> flat_map;
+
+		for (int step = 0; step < 5; ++step)
+		{
+			vector<int> batch(gen() % 50);
+			vector<pair<int, int>> pairs;
+			for (auto& val : batch)
+			{
+				val = gen() % 100;
+				pairs.push_back({ val, step });
+			}
+
+			ref_multi.insert(batch.begin(), batch.end());
+			ref_set.insert(batch.begin(), batch.end());
+			ref_map.insert(pairs.begin(), pairs.end());
+			multi.insert_range(batch.begin(), batch.end());
+			flat_set.insert_range(batch.begin(), batch.end());
+			flat_map.insert_range(pairs.begin(), pairs.end());
+
+			const int single = gen() % 100;
+			ref_multi.insert(single);
+			ref_set.insert(single);
+			ref_map.insert({ single, -1 });
+			multi.insert(single);
+			flat_set.insert(single);
+			flat_map.insert({ single, -1 });
+
+			const int removed = gen() % 100;
+			ref_multi.erase(removed);
+			ref_set.erase(removed);
+			ref_map.erase(removed);
+			multi.erase(removed);
+			flat_set.erase(removed);
+			flat_map.erase(removed);
+		}
+
+		ok = ok && vector<int>(ref_multi.begin(), ref_multi.end()) == vector<int>(multi.data(), multi.data() + multi.size());
+		ok = ok && vector<int>(ref_set.begin(), ref_set.end()) == vector<int>(flat_set.data(), flat_set.data() + flat_set.size());
+		ok = ok && ref_map.size() == flat_map.size();
+
+		for (int pass = 0; pass < 2; ++pass)
+		{
+			for (int key = -1; key <= 100; ++key)
+			{
+				ok = ok && static_cast<size_t>(distance(ref_multi.begin(), ref_multi.lower_bound(key))) == static_cast<size_t>(multi.lower_bound(key) - multi.cbegin());
+				ok = ok && static_cast<size_t>(distance(ref_multi.begin(), ref_multi.upper_bound(key))) == static_cast<size_t>(multi.upper_bound(key) - multi.cbegin());
+				ok = ok && ref_multi.count(key) == multi.count(key);
+				ok = ok && ref_set.count(key) == flat_set.count(key);
+				ok = ok && ref_map.count(key) == flat_map.count(key);
+				if (ref_map.count(key))
+					ok = ok && ref_map.at(key) == flat_map.at(key);
+			}
+
+			multi.build_index();
+			flat_set.build_index();
+			flat_map.build_index();
+		}
+	}
+	return ok;
+}
+
+// Spike, drain and push/pop around the threshold with the default shrink policy (shrink below 1/4, keep 2x, at least 16)
+bool shrink_policy_works()
+{
+	Vector<int>::ShrinkPolicy policy;
+	policy.enabled = true;
+	bool ok = true;
+
+	Vector<int> vec;
+	vec.set_shrink_policy(policy);
+	for (int i = 0; i < 1024; ++i)
+		vec.push_back(i);
+
+	// 256 is exactly a quarter, one more pop goes below it and the capacity is cut to twice the size
+	while (vec.size() > 256)
+		vec.pop_back();
+	ok = ok && vec.capacity() == 1024;
+	vec.pop_back();
+	ok = ok && vec.capacity() == 510;
+
+	// Push/pop right around the threshold must not reallocate
+	const int* const before = vec.data();
+	for (int i = 0; i < 1000; ++i)
+	{
+		vec.push_back(i);
+		vec.pop_back();
+	}
+	ok = ok && vec.data() == before && vec.capacity() == 510;
+
+	// Draining further never goes below min_capacity
+	while (vec.size() > 3)
+		vec.pop_back();
+	ok = ok && vec.capacity() == policy.min_capacity;
+	for (int i = 0; i < 3; ++i)
+		ok = ok && vec[i] == i;
+
+	// clear() gives back the whole capacity
+	const size_t returned = vec.memory_returned();
+	const size_t cap = vec.capacity();
+	vec.clear();
+	ok = ok && vec.memory_returned() == returned + cap * sizeof(int);
+
+	// erase() shrinks, the returned iterator has to point into the new storage
+	Vector<int> erased;
+	erased.set_shrink_policy(policy);
+	for (int i = 0; i < 64; ++i)
+		erased.push_back(i);
+	const auto it = erased.erase(erased.begin() + 1, erased.begin() + 60);
+	ok = ok && erased.capacity() == 16 && erased.size() == 5;
+	ok = ok && it - erased.begin() == 1 && *it == 60;
+
+	// trim() keeps at most the given amount of spare bytes and returns what it gave back
+	Vector<int> trimmed;
+	trimmed.reserve(16);
+	for (int i = 0; i < 10; ++i)
+		trimmed.push_back(i);
+	ok = ok && trimmed.trim(6 * sizeof(int)) == 0 && trimmed.capacity() == 16;
+	ok = ok && trimmed.trim(2 * sizeof(int)) == 4 * sizeof(int) && trimmed.capacity() == 12;
+	ok = ok && trimmed.trim(0) == 2 * sizeof(int) && trimmed.capacity() == 10;
+	for (int i = 0; i < 10; ++i)
+		ok = ok && trimmed[i] == i;
+
+	return ok;
+}
+
+// Counts how many times an adopted buffer got freed
+size_t adopted_frees = 0;
+void counting_free(void* ptr)
+{
+	++adopted_frees;
+	free(ptr);
+}
+
+int* adoptable_buffer(size_t cap, size_t siz)
+{
+	int* const ptr = (int*) malloc(cap * sizeof(int));
+	for (size_t i = 0; i < siz; ++i)
+		ptr[i] = static_cast<int>(i);
+	return ptr;
+}
+
+// The deleter of an adopted buffer has to run exactly once, whichever way the buffer goes away
+bool adopt_release_views_work()
+{
+	bool ok = true;
+
+	// Reallocation
+	adopted_frees = 0;
+	{
+		Vector<int> vec;
+		vec.adopt(adoptable_buffer(4, 4), 4, 4, &counting_free);
+		vec.push_back(4);
+		ok = ok && adopted_frees == 1 && vec.get_deleter() == &std::free;
+		for (int i = 0; i < 5; ++i)
+			ok = ok && vec[i] == i;
+	}
+	ok = ok && adopted_frees == 1;
+
+	// shrink_to_fit
+	adopted_frees = 0;
+	{
+		Vector<int> vec;
+		vec.adopt(adoptable_buffer(8, 4), 4, 8, &counting_free);
+		vec.shrink_to_fit();
+		ok = ok && adopted_frees == 1 && vec.capacity() == 4 && vec[3] == 3;
+	}
+	ok = ok && adopted_frees == 1;
+
+	// Destruction
+	adopted_frees = 0;
+	{
+		Vector<int> vec;
+		vec.adopt(adoptable_buffer(8, 4), 4, 8, &counting_free);
+		ok = ok && adopted_frees == 0 && vec.get_deleter() == &counting_free;
+	}
+	ok = ok && adopted_frees == 1;
+
+	// Move construction hands the deleter over together with the buffer
+	adopted_frees = 0;
+	{
+		Vector<int> from;
+		from.adopt(adoptable_buffer(8, 4), 4, 8, &counting_free);
+		{
+			Vector<int> to(std::move(from));
+			ok = ok && to.get_deleter() == &counting_free && from.get_deleter() == &std::free;
+			ok = ok && to.size() == 4 && from.empty();
+		}
+		ok = ok && adopted_frees == 1;
+	}
+	ok = ok && adopted_frees == 1;
+
+	// release() leaves an empty Vector, the caller frees the buffer with the deleter it got back
+	adopted_frees = 0;
+	{
+		Vector<int> vec;
+		vec.adopt(adoptable_buffer(8, 4), 4, 8, &counting_free);
+		const Vector<int>::ReleasedStorage released = vec.release();
+		ok = ok && vec.empty() && vec.capacity() == 0 && vec.get_deleter() == &std::free;
+		ok = ok && released.size == 4 && released.capacity == 8 && released.deleter == &counting_free && released.ptr[3] == 3;
+		released.deleter(released.ptr);
+
+		Vector<int> plain({ 1, 2, 3 });
+		const Vector<int>::ReleasedStorage plain_released = plain.release();
+		ok = ok && plain_released.deleter == &std::free;
+		plain_released.deleter(plain_released.ptr);
+	}
+	ok = ok && adopted_frees == 1;
+
+	// Views and subviews, including the edges
+	Vector<int> vec({ 0, 1, 2, 3, 4, 5 });
+	const VectorView<int> middle = vec.view(2, 3);
+	ok = ok && middle.size() == 3 && middle.front() == 2 && middle.back() == 4;
+	ok = ok && vec.view(6, 0).empty() && vec.view(0, 6).size() == 6;
+	ok = ok && middle.subview(1, 2)[1] == 4 && middle.subview(3, 0).empty();
+
+	middle[0] = 20;
+	const VectorView<const int> read_only = middle;
+	ok = ok && read_only.data() == vec.data() + 2 && read_only[0] == 20;
+	ok = ok && vec.cview(1, 2).size() == 2 && vec.cview(1, 2)[1] == 20;
+
+	int sum = 0;
+	for (const int val : read_only)
+		sum += val;
+	ok = ok && sum == 20 + 3 + 4;
+
+	return ok;
+}
+
+// Random row edits compared against a vector of vectors. Truncated rows keep their slack until compact(), so pushing back
+// into a truncated last row and popping rows with slack around are the interesting cases
+bool jagged_vector_matches()
+{
+	mt19937 gen(7);
+	bool ok = true;
+
+	for (int round = 0; round < 50; ++round)
+	{
+		vector<vector<int>> ref;
+		JaggedVector<int> jagged;
+
+		for (int step = 0; step < 200; ++step)
+		{
+			const unsigned op = gen() % 8;
+
+			if (op <= 1 || ref.empty())
+			{
+				vector<int> row(gen() % 8);
+				for (auto& val : row)
+					val = static_cast<int>(gen() % 1000);
+				ref.push_back(row);
+				jagged.push_row(row);
+			}
+			else if (op == 2)
+			{
+				const int val = static_cast<int>(gen() % 1000);
+				ref.back().push_back(val);
+				jagged.push_back(val);
+			}
+			else if (op == 3)
+			{
+				ref.pop_back();
+				jagged.pop_row();
+			}
+			else if (op <= 5)
+			{
+				const size_t row = gen() % ref.size();
+				const size_t new_size = ref[row].empty() ? 0 : gen() % (ref[row].size() + 1);
+				ref[row].resize(new_size);
+				jagged.truncate_row(row, new_size);
+			}
+			else if (op == 6)
+			{
+				jagged.compact();
+				ok = ok && jagged.slack() == 0;
+			}
+			else if (gen() % 4 == 0)
+			{
+				jagged.shrink_to_fit();
+			}
+
+			size_t total = 0;
+			ok = ok && jagged.size() == ref.size();
+			for (size_t row = 0; ok && row < ref.size(); ++row)
+			{
+				const VectorView<const int> view = jagged.crow(row);
+				ok = ok && view.size() == ref[row].size() && vector<int>(view.begin(), view.end()) == ref[row];
+				total += ref[row].size();
+			}
+			ok = ok && jagged.total_size() == total;
+		}
+	}
+	return ok;
+}
+
+// Input-only source of 0, 1, 2, ..., it can be walked only once
+class CountingInput
+{
+public:
+	class Iter
+	{
+	public:
+		using iterator_category = input_iterator_tag;
+		using value_type = int;
+		using difference_type = ptrdiff_t;
+		using pointer = const int*;
+		using reference = int;
+		size_t pos;
+		int operator*() const { return static_cast<int>(pos); }
+		Iter& operator++() { ++pos; return *this; }
+		bool operator==(const Iter& rhs) const { return pos == rhs.pos; }
+		bool operator!=(const Iter& rhs) const { return pos != rhs.pos; }
+	};
+private:
+	size_t count;
+public:
+	explicit CountingInput(size_t cnt) : count(cnt) {}
+	Iter begin() const { return Iter{ 0 }; }
+	Iter end() const { return Iter{ count }; }
+};
+
+class HintedCountingInput : public CountingInput
+{
+private:
+	size_t count;
+public:
+	explicit HintedCountingInput(size_t cnt) : CountingInput(cnt), count(cnt) {}
+	size_t size_hint() const { return count; }
+};
+
+bool holds_counting(const Vector<int>& vec, size_t count)
+{
+	bool ok = vec.size() == count && vec.capacity() == count;
+	for (size_t i = 0; ok && i < count; ++i)
+		ok = vec[i] == static_cast<int>(i);
+	return ok;
+}
+
+// Single pass sources are staged in chunks (4 KB growing up to 4 MB) and stitched together at the end, the sizes go across
+// chunk boundaries and 3.5M ints fill all the growing chunks plus a few of the biggest ones
+bool streaming_construction_works()
+{
+	bool ok = true;
+
+	for (const size_t count : { 0, 1, 1023, 1024, 1025, 3'500'000 })
+	{
+		CountingInput src(count);
+		ok = ok && holds_counting(Vector<int>(src.begin(), src.end()), count);
+		ok = ok && holds_counting(Vector<int>(from_range_tag, src), count);
+		ok = ok && holds_counting(Vector<int>(from_range_tag, HintedCountingInput(count)), count);
+
+		Vector<int> assigned({ -1, -2, -3 });
+		assigned.assign(src.begin(), src.end());
+		ok = ok && holds_counting(assigned, count);
+
+		string text;
+		for (size_t i = 0; i < count; ++i)
+			text += to_string(i) + ' ';
+		istringstream in(text);
+		ok = ok && holds_counting(Vector<int>(istream_iterator<int>(in), istream_iterator<int>()), count);
+	}
+	return ok;
+}
+
 int main()
 {
 	Vector<DynClass> V1;
@@ -113,4 +499,10 @@ int main()
 	cout << endl << "V8:" << endl;
 	for (auto& val : V8) cout << val;
 	cout << endl;
+
+	cout << endl << "SortedVector/FlatSet/FlatMap vs std: " << (flat_containers_match() ? "match" : "MISMATCH") << endl;
+	cout << "Shrink policy: " << (shrink_policy_works() ? "ok" : "FAILED") << endl;
+	cout << "Adopt/release/views: " << (adopt_release_views_work() ? "ok" : "FAILED") << endl;
+	cout << "JaggedVector vs std: " << (jagged_vector_matches() ? "match" : "MISMATCH") << endl;
+	cout << "Streaming construction: " << (streaming_construction_works() ? "ok" : "FAILED") << endl;
 }
\ No newline at end of file
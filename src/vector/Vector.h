@@ -1,12 +1,19 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdlib>
 #include "../errors and sfinae/sfinae.h"
 #include "../errors and sfinae/errors.h"
+#include "VectorView.h"
 
 // Using declarations
 using std::size_t;
 using std::ptrdiff_t;
 
+// Picks the range constructor, the same idea as std::from_range from C++23
+struct from_range_tag_t { explicit from_range_tag_t() = default; };
+inline constexpr from_range_tag_t from_range_tag{};
+
 template<typename T>
 class Vector
 {
@@ -207,13 +214,52 @@ public:
 	using ConstIterator = VectorIterator<true>;
 	using ReverseIterator = ReverseVectorIterator<false>;
 	using ConstReverseIterator = ReverseVectorIterator<true>;
+	using Deleter = void (*)(void*); // Frees the storage, std::free unless an adopted buffer came with its own
+
+	// Opt-in automatic memory return. Once size() drops below capacity() * shrink_below, the capacity is cut down to size() * keep_headroom.
+	// shrink_below * keep_headroom has to stay below 1, the gap between both thresholds keeps push/pop around one of them from reallocating every time
+	struct ShrinkPolicy
+	{
+		bool enabled = false;
+		double shrink_below = 0.25;
+		double keep_headroom = 2.0;
+		size_t min_capacity = 16; // Small vectors are not worth the reallocation
+	};
+
+	// What release() hands over. The elements are still alive, they have to be destroyed before deleter(ptr) is called
+	struct ReleasedStorage
+	{
+		T* ptr;
+		size_t size;
+		size_t capacity;
+		Deleter deleter;
+	};
+private:
+	// Rarely used state, allocated only when a feature needs it so that it doesn't make every Vector bigger
+	struct Extras
+	{
+		ShrinkPolicy shrink_policy;
+		size_t returned_bytes = 0;
+		Deleter storage_deleter = nullptr; // nullptr means std::free
+	};
 private:
 	T* storage = nullptr;
 	size_t vec_size = 0;
 	size_t vec_capacity = 0;
+	Extras* extras = nullptr;
+
+	// Chunk sizes (in elements) for staging values from a source of unknown size, roughly 4 KB growing up to 4 MB
+	static constexpr size_t stream_chunk_min = std::max<size_t>(1, 4096 / sizeof(T));
+	static constexpr size_t stream_chunk_max = std::max<size_t>(1, (4096 * 1024) / sizeof(T));
 private:
 	void construct(size_t size) noexcept;
+	template<typename Iter, typename Sentinel> void construct_from_stream(Iter it, Sentinel last) noexcept;
+	template<typename Range> static size_t source_size_hint(const Range& range) noexcept;
 	void re_alloc(size_t new_cap) noexcept;
+	void shrink_if_sparse() noexcept;
+	Extras& get_extras() noexcept { if (!extras) extras = new Extras; return *extras; }
+	void count_returned(const size_t bytes) noexcept { if (extras && extras->shrink_policy.enabled) extras->returned_bytes += bytes; }
+	void copy_shrink_policy(const Vector& rhs) noexcept;
 	void uninitialized_fill(const T& val) noexcept;
 	bool should_re_alloc(const size_t offset = 1) const noexcept { return vec_size + offset > vec_capacity; }
 	size_t double_capacity_0_prevented() const noexcept { return vec_capacity == 0 ? 1 : vec_capacity * 2; }
@@ -226,12 +272,13 @@ public:
 	explicit Vector(const size_t siz) noexcept;
 	Vector(const size_t siz, const T& val) noexcept;
 	Vector(const std::initializer_list<T>& init) noexcept;
-	template<typename Iter> Vector(Iter it1, Iter it2, require_forward_it<Iter>* = nullptr) noexcept;
+	template<typename Iter> Vector(Iter it1, Iter it2, require_input_it<Iter>* = nullptr) noexcept;
+	template<typename Range> Vector(from_range_tag_t, Range&& range) noexcept;
 	Vector(const Vector& rhs) noexcept;
 	Vector& operator=(const Vector& rhs) noexcept;
 	Vector(Vector&& rhs) noexcept;
 	Vector& operator=(Vector&& rhs) noexcept;
-	template<typename Iter> void assign(Iter it1, Iter it2, require_forward_it<Iter>* = nullptr) noexcept;
+	template<typename Iter> void assign(Iter it1, Iter it2, require_input_it<Iter>* = nullptr) noexcept;
 	void fill(const T& val) noexcept;
 	size_t size() const noexcept { return vec_size; }
 	size_t capacity() const noexcept { return vec_capacity; }
@@ -244,11 +291,27 @@ public:
 	void push_back(const T& val) noexcept;
 	template<typename... Args> T& emplace_back(Args&&... args) noexcept;
 	Iterator insert(ConstIterator it, const T& val) noexcept;
+	template<typename Iter> Iterator insert(ConstIterator it, Iter it1, Iter it2, require_forward_it<Iter>* = nullptr) noexcept;
 	template<typename... Args> Iterator emplace(ConstIterator it, Args&&... args) noexcept;
 	void pop_back() noexcept;
 	void reserve(const size_t new_cap) noexcept;
 	void resize(const size_t new_size, const T& val) noexcept;
 	void shrink_to_fit() noexcept;
+	size_t trim(const size_t bytes_budget) noexcept;
+	void set_shrink_policy(const ShrinkPolicy& policy) noexcept;
+	ShrinkPolicy get_shrink_policy() const noexcept { return extras ? extras->shrink_policy : ShrinkPolicy(); }
+	size_t memory_returned() const noexcept { return extras ? extras->returned_bytes : 0; } // Bytes given back while a shrink policy was enabled
+	void adopt(T* ptr, const size_t siz, const size_t cap, Deleter deleter = &std::free) noexcept;
+	ReleasedStorage release() noexcept;
+	Deleter get_deleter() const noexcept { return extras && extras->storage_deleter ? extras->storage_deleter : &std::free; }
+	VectorView<T> view() const noexcept { return VectorView<T>(storage, vec_size); }
+	VectorView<T> view(const size_t offset, const size_t count) const noexcept { return view().subview(offset, count); }
+	VectorView<const T> cview() const noexcept { return VectorView<const T>(storage, vec_size); }
+	VectorView<const T> cview(const size_t offset, const size_t count) const noexcept { return cview().subview(offset, count); }
+#ifdef __cpp_lib_span
+	operator std::span<T>() const noexcept { return std::span<T>(storage, vec_size); }
+	operator std::span<const T>() const noexcept { return std::span<const T>(storage, vec_size); }
+#endif
 	void clear() noexcept;
 	void swap(Vector<T>& rhs) noexcept;
 	Iterator erase(Iterator it1, Iterator it2) noexcept;
@@ -267,6 +330,8 @@ template<typename T>
 void Vector<T>::construct(size_t cap) noexcept
 {
 	storage = (T*) malloc(cap * sizeof(T));
+	if (extras)
+		extras->storage_deleter = nullptr;
 	vec_capacity = cap;
 	vec_size = vec_capacity;
 }
@@ -274,6 +339,9 @@ void Vector<T>::construct(size_t cap) noexcept
 template<typename T>
 void Vector<T>::re_alloc(size_t new_cap) noexcept
 {
+	if (new_cap < vec_capacity)
+		count_returned((vec_capacity - new_cap) * sizeof(T));
+
 	// Allocate a chunk of memory
 	T* temp = (T*) malloc(new_cap * sizeof(T));
 
@@ -320,33 +388,126 @@ Vector<T>::Vector(const std::initializer_list<T>& init) noexcept
 		storage[i++] = val;
 }
 
+template<typename T>
+template<typename Iter, typename Sentinel>
+void Vector<T>::construct_from_stream(Iter it, Sentinel last) noexcept
+{
+	// The size is unknown until the source runs dry, so the values are staged in chunks that never move (instead of doubling
+	// and moving everything log n times). The final storage is allocated once, with the exact size, and the chunks are stitched into it
+	Vector<T*> chunks;
+	T* chunk = nullptr;
+	size_t chunk_cap = stream_chunk_min;
+	size_t filled = chunk_cap;
+	size_t total = 0;
+
+	for (; it != last; ++it, ++total)
+	{
+		if (filled == chunk_cap)
+		{
+			if (chunk)
+				chunk_cap = std::min(chunk_cap * 2, stream_chunk_max);
+			chunk = (T*) malloc(chunk_cap * sizeof(T));
+			chunks.push_back(chunk);
+			filled = 0;
+		}
+		new (&chunk[filled++]) T(*it);
+	}
+
+	construct(total);
+
+	// Chunk sizes are replayed the same way they grew, only the last chunk can be partially filled
+	size_t pos = 0;
+	chunk_cap = stream_chunk_min;
+	for (size_t c = 0; c < chunks.size(); ++c)
+	{
+		const size_t count = c + 1 == chunks.size() ? filled : chunk_cap;
+		T* staged = chunks[c];
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			storage[pos++] = std::move(staged[i]);
+			staged[i].~T();
+		}
+
+		free(staged);
+		chunk_cap = std::min(chunk_cap * 2, stream_chunk_max);
+	}
+}
+
+template<typename T>
+template<typename Range>
+size_t Vector<T>::source_size_hint(const Range& range) noexcept
+{
+	if constexpr (has_size_hint<Range>::value)
+		return range.size_hint();
+	else
+		return range.size();
+}
+
 template<typename T>
 template<typename Iter>
-Vector<T>::Vector(Iter it1, Iter it2, require_forward_it<Iter>*) noexcept
+Vector<T>::Vector(Iter it1, Iter it2, require_input_it<Iter>*) noexcept
 {
-	construct(std::distance(it1, it2));
+	// Single pass iterators (istream_iterator etc.) can't be measured up front
+	if constexpr (!is_forward_it_v<Iter>)
+	{
+		construct_from_stream(it1, it2);
+	}
+	else
+	{
+		construct(std::distance(it1, it2));
 
-	// Copy data
-	for (size_t i = 0; it1 != it2; ++i, ++it1)
-		storage[i] = *it1;
+		// Copy data
+		for (size_t i = 0; it1 != it2; ++i, ++it1)
+			storage[i] = *it1;
+	}
+}
+
+template<typename T>
+template<typename Range>
+Vector<T>::Vector(from_range_tag_t, Range&& range) noexcept
+{
+	// No hint, no way to know the size without consuming the range (generators, sentinel-terminated ranges)
+	if constexpr (!reports_size_v<Range>)
+	{
+		construct_from_stream(std::begin(range), std::end(range));
+	}
+	else
+	{
+		// The hint is only trusted for the first allocation, a wrong one just means growing (or spare capacity) later
+		construct(0);
+		reserve(source_size_hint(range));
+
+		for (auto&& val : range)
+			emplace_back(std::forward<decltype(val)>(val));
+	}
 }
 
 template<typename T>
 template<typename Iter>
-void Vector<T>::assign(Iter it1, Iter it2, require_forward_it<Iter>*) noexcept
+void Vector<T>::assign(Iter it1, Iter it2, require_input_it<Iter>*) noexcept
 {
 	destroy();
-	construct(std::distance(it1, it2));
 
-	// Copy data
-	for (size_t i = 0; it1 != it2; ++i, ++it1)
-		storage[i] = *it1;
+	if constexpr (!is_forward_it_v<Iter>)
+	{
+		construct_from_stream(it1, it2);
+	}
+	else
+	{
+		construct(std::distance(it1, it2));
+
+		// Copy data
+		for (size_t i = 0; it1 != it2; ++i, ++it1)
+			storage[i] = *it1;
+	}
 }
 
 template<typename T>
 Vector<T>::Vector(const Vector& rhs) noexcept
 {
 	construct(rhs.vec_capacity);
+	copy_shrink_policy(rhs);
 
 	// Copy data
 	for (size_t i = 0; i < vec_size; ++i)
@@ -360,6 +521,7 @@ Vector<T>& Vector<T>::operator=(const Vector& rhs) noexcept
 	{
 		destroy();
 		construct(rhs.vec_capacity);
+		copy_shrink_policy(rhs);
 
 		// Copy data
 		for (size_t i = 0; i < vec_size; ++i)
@@ -375,15 +537,17 @@ Vector<T>::Vector(Vector&& rhs) noexcept
 	storage = rhs.storage;
 	vec_capacity = rhs.vec_capacity;
 	vec_size = rhs.vec_size;
+	extras = rhs.extras;
 
 	// Rhs
+	rhs.extras = nullptr;
 	rhs.construct(0);
 }
 
 template<typename T>
 Vector<T>& Vector<T>::operator=(Vector&& rhs) noexcept
 {
-	if (this == &rhs)
+	if (this != &rhs)
 	{
 		destroy();
 
@@ -391,8 +555,11 @@ Vector<T>& Vector<T>::operator=(Vector&& rhs) noexcept
 		storage = rhs.storage;
 		vec_capacity = rhs.vec_capacity;
 		vec_size = rhs.vec_size;
+		delete extras;
+		extras = rhs.extras;
 
 		// Rhs
+		rhs.extras = nullptr;
 		rhs.construct(0);
 	}
 	return *this;
@@ -459,6 +626,35 @@ typename Vector<T>::Iterator Vector<T>::insert(ConstIterator it, const T& val) n
 	return Iterator(storage + index, *this);
 }
 
+template<typename T>
+template<typename Iter>
+typename Vector<T>::Iterator Vector<T>::insert(ConstIterator it, Iter it1, Iter it2, require_forward_it<Iter>*) noexcept
+{
+	err::exit_if(have_diff_owner(it), err::diff_vectors);
+
+	// Sneaky index calculation
+	const size_t index = it - cbegin();
+	const size_t count = std::distance(it1, it2);
+
+	// Nothing to insert, the shift below would only move every tail element onto itself
+	if (count == 0)
+		return Iterator(storage + index, *this);
+
+	if (should_re_alloc(count))
+		re_alloc(std::max(vec_size + count, double_capacity_0_prevented()));
+
+	// Moving backwards and making space for the whole range at once, so the tail is shifted only one time
+	for (size_t i = vec_size; i > index; --i)
+		storage[i - 1 + count] = std::move(storage[i - 1]);
+
+	// Copy the range into the created space
+	for (size_t i = index; it1 != it2; ++i, ++it1)
+		storage[i] = *it1;
+
+	vec_size += count;
+	return Iterator(storage + index, *this);
+}
+
 template<typename T>
 template<typename... Args>
 typename Vector<T>::Iterator Vector<T>::emplace(ConstIterator it, Args&&... args) noexcept
@@ -486,6 +682,7 @@ void Vector<T>::pop_back() noexcept
 {
 	err::exit_if(empty(), err::pop_empty_vector);
 	storage[--vec_size].~T();
+	shrink_if_sparse();
 }
 
 template<typename T>
@@ -501,17 +698,14 @@ void Vector<T>::resize(const size_t new_size, const T& val) noexcept
 	if (new_size == vec_size)
 		return; // Nothing to do if equal
 
-	// Basically re_alloc with some differences if the new size is less than the current one
+	// Shrinking keeps the storage, only the shrink policy may reallocate (once)
 	if (new_size < vec_size)
 	{
-		T* temp = (T*) malloc(vec_capacity * sizeof(T));
-
-		for (size_t i = 0; i < new_size; ++i)
-			temp[i] = std::move(storage[i]);
+		for (size_t i = new_size; i < vec_size; ++i)
+			storage[i].~T();
 
-		destroy();
-		storage = temp;
 		vec_size = new_size;
+		shrink_if_sparse();
 		return;
 	}
 
@@ -535,9 +729,85 @@ void Vector<T>::shrink_to_fit() noexcept
 		re_alloc(vec_size);
 }
 
+template<typename T>
+size_t Vector<T>::trim(const size_t bytes_budget) noexcept
+{
+	const size_t spare_budget = bytes_budget / sizeof(T);
+
+	// Keeps at most bytes_budget of unused capacity, trim(0) is the same as shrink_to_fit()
+	if (vec_capacity - vec_size <= spare_budget)
+		return 0;
+
+	const size_t returned = (vec_capacity - vec_size - spare_budget) * sizeof(T);
+	re_alloc(vec_size + spare_budget);
+	return returned;
+}
+
+template<typename T>
+void Vector<T>::set_shrink_policy(const ShrinkPolicy& policy) noexcept
+{
+	err::exit_if(policy.shrink_below <= 0 || policy.keep_headroom < 1 || policy.shrink_below * policy.keep_headroom >= 1, err::bad_shrink_policy);
+
+	// A disabled policy doesn't need the extras, unless they are already there
+	if (!policy.enabled && !extras)
+		return;
+
+	get_extras().shrink_policy = policy;
+	shrink_if_sparse();
+}
+
+template<typename T>
+void Vector<T>::copy_shrink_policy(const Vector& rhs) noexcept
+{
+	if (rhs.extras && rhs.extras->shrink_policy.enabled)
+		get_extras().shrink_policy = rhs.extras->shrink_policy;
+	else if (extras)
+		extras->shrink_policy.enabled = false;
+}
+
+template<typename T>
+void Vector<T>::shrink_if_sparse() noexcept
+{
+	if (!extras || !extras->shrink_policy.enabled)
+		return;
+
+	const ShrinkPolicy& policy = extras->shrink_policy;
+
+	if (vec_capacity <= policy.min_capacity || vec_size >= vec_capacity * policy.shrink_below)
+		return;
+
+	re_alloc(std::max(static_cast<size_t>(vec_size * policy.keep_headroom), policy.min_capacity));
+}
+
+template<typename T>
+void Vector<T>::adopt(T* ptr, const size_t siz, const size_t cap, Deleter deleter) noexcept
+{
+	err::exit_if(siz > cap, err::adopt_size_over_capacity);
+	destroy();
+
+	// Taking over the buffer as it is, no copying. The deleter is called on it once the Vector is done with it
+	storage = ptr;
+	vec_size = siz;
+	vec_capacity = cap;
+
+	// Only a custom deleter needs the extras
+	if (deleter && deleter != &std::free)
+		get_extras().storage_deleter = deleter;
+}
+
+template<typename T>
+typename Vector<T>::ReleasedStorage Vector<T>::release() noexcept
+{
+	// The caller now owns the elements and the buffer, everything needed to free them goes along
+	const ReleasedStorage released{ storage, vec_size, vec_capacity, get_deleter() };
+	construct(0);
+	return released;
+}
+
 template<typename T>
 void Vector<T>::clear() noexcept
 {
+	count_returned(vec_capacity * sizeof(T));
 	destroy();
 	construct(0);
 }
@@ -561,6 +831,9 @@ typename Vector<T>::Iterator Vector<T>::erase(Iterator it1, Iterator it2) noexce
 	if (is_same_iter(it1, it2))
 		return it2;
 
+	// The shrink policy may move the storage, so the returned iterator (to the element after the erased ones) is rebuilt from the index
+	const ptrdiff_t index = it1 - begin();
+
 	for (auto it = it1; it != it2; ++it)
 		(*it).~T();
 
@@ -576,7 +849,8 @@ typename Vector<T>::Iterator Vector<T>::erase(Iterator it1, Iterator it2) noexce
 	vec_size = vec_size - (it2 - it1); // I think it is safe to do because (subtraction of int and unsigned int), it2 - it1 will never be < 0 unless
 								      // it2 < it1 but even if, abort will be called
 
-	return it2;
+	shrink_if_sparse();
+	return Iterator(storage + index, *this);
 }
 
 template<typename T>
@@ -586,7 +860,11 @@ void Vector<T>::destroy()
 	if (!empty()) // Do only if not empty, otherwise vec_size == 0, vec_size - 1 == ~ 4 mld what causes problems
 		for (size_t i = 0; i < vec_size - 1; ++i)
 			storage[i].~T();
-	free(storage);
+	get_deleter()(storage);
+
+	// Every new storage is allocated with malloc
+	if (extras)
+		extras->storage_deleter = nullptr;
 }
 
 
@@ -594,4 +872,5 @@ template<typename T>
 Vector<T>::~Vector()
 {
 	destroy();
+	delete extras;
 }
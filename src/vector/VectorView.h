@@ -0,0 +1,134 @@
+#pragma once
+
+#if __has_include(<version>)
+#include <version>
+#endif
+#ifdef __cpp_lib_span
+#include <span>
+#endif
+
+#include "../errors and sfinae/sfinae.h"
+#include "../errors and sfinae/errors.h"
+
+using std::size_t;
+using std::ptrdiff_t;
+
+// Non-owning view over a contiguous range (a whole Vector or a part of it). Copying a view never copies the elements.
+// Its iterators are checked against the bounds of the view, just like the Vector iterators are checked against the Vector
+template<typename T>
+class VectorView
+{
+private:
+	class ViewIterator
+	{
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = std::remove_const_t<T>;
+		using difference_type = ptrdiff_t;
+		using pointer = T*;
+		using reference = T&;
+		friend VectorView<T>;
+	private:
+		T* ptr = nullptr;
+		T* first = nullptr;
+		T* last = nullptr;
+	private:
+		ViewIterator(T* p, T* f, T* l) noexcept : ptr(p), first(f), last(l) {}
+	public:
+		ViewIterator& operator++() noexcept
+		{
+			err::exit_if(ptr == last, err::increment_end);
+			++ptr;
+			return *this;
+		}
+		ViewIterator operator++(int) noexcept
+		{
+			ViewIterator temp(*this);
+			operator++();
+			return temp;
+		}
+		ViewIterator& operator--() noexcept
+		{
+			err::exit_if(ptr == first, err::decrement_begin);
+			--ptr;
+			return *this;
+		}
+		ViewIterator operator--(int) noexcept
+		{
+			ViewIterator temp(*this);
+			operator--();
+			return temp;
+		}
+		ViewIterator operator+(const size_t offset) const noexcept
+		{
+			ViewIterator temp(*this);
+			return temp += offset;
+		}
+		ViewIterator& operator+=(const size_t offset) noexcept
+		{
+			err::exit_if(offset > static_cast<size_t>(last - ptr), err::traversed_vector);
+			ptr += offset;
+			return *this;
+		}
+		ViewIterator operator-(const size_t offset) const noexcept
+		{
+			ViewIterator temp(*this);
+			return temp -= offset;
+		}
+		ViewIterator& operator-=(const size_t offset) noexcept
+		{
+			err::exit_if(offset > static_cast<size_t>(ptr - first), err::traversed_vector);
+			ptr -= offset;
+			return *this;
+		}
+		ptrdiff_t operator-(const ViewIterator& it) const noexcept { return ptr - it.ptr; }
+		T& operator*() const noexcept
+		{
+			err::exit_if(ptr == last, err::deref_end);
+			return *ptr;
+		}
+		T* operator->() const noexcept { return ptr; }
+		T& operator[](const size_t offset) const noexcept
+		{
+			err::exit_if(offset >= static_cast<size_t>(last - ptr), err::traversed_vector);
+			return ptr[offset];
+		}
+		bool operator==(const ViewIterator& it) const noexcept { return ptr == it.ptr; }
+		bool operator!=(const ViewIterator& it) const noexcept { return ptr != it.ptr; }
+		bool operator<(const ViewIterator& it) const noexcept { return ptr < it.ptr; }
+		bool operator<=(const ViewIterator& it) const noexcept { return ptr <= it.ptr; }
+		bool operator>(const ViewIterator& it) const noexcept { return ptr > it.ptr; }
+		bool operator>=(const ViewIterator& it) const noexcept { return ptr >= it.ptr; }
+	};
+public:
+	using Iterator = ViewIterator;
+private:
+	T* first = nullptr;
+	size_t view_size = 0;
+public:
+	VectorView() noexcept = default;
+	VectorView(T* ptr, const size_t siz) noexcept : first(ptr), view_size(siz) {}
+	template<typename U, typename = std::enable_if_t<std::is_same_v<const U, T>>>
+	VectorView(const VectorView<U>& rhs) noexcept : first(rhs.data()), view_size(rhs.size()) {} // non-const to const view conversion
+	size_t size() const noexcept { return view_size; }
+	bool empty() const noexcept { return view_size == 0; }
+	T* data() const noexcept { return first; }
+	T& front() const noexcept { err::exit_if(empty(), err::front_empty_vector); return first[0]; }
+	T& back() const noexcept { err::exit_if(empty(), err::back_empty_vector); return first[view_size - 1]; }
+	T& operator[](size_t index) const noexcept { err::exit_if(index >= view_size, err::subscript_out_of_range); return first[index]; }
+	VectorView subview(const size_t offset, const size_t count) const noexcept;
+	Iterator begin() const noexcept { return Iterator(first, first, first + view_size); }
+	Iterator end() const noexcept { return Iterator(first + view_size, first, first + view_size); }
+#ifdef __cpp_lib_span
+	operator std::span<T>() const noexcept { return std::span<T>(first, view_size); }
+	template<typename U = T, typename = std::enable_if_t<std::is_same_v<U, T> && !std::is_const_v<U>>>
+	operator std::span<const U>() const noexcept { return std::span<const U>(first, view_size); } // Already covered above when T is const
+#endif
+};
+
+template<typename T>
+VectorView<T> VectorView<T>::subview(const size_t offset, const size_t count) const noexcept
+{
+	err::exit_if(offset > view_size || count > view_size - offset, err::view_out_of_range);
+	return VectorView(first + offset, count);
+}